@@ -0,0 +1,1764 @@
+// Copyright (c) 2020 RedRock Biometrics. All rights reserved.
+#ifndef __PALM_ID_H__
+#define __PALM_ID_H__
+
+#ifndef PALM_EXPORT
+#ifdef _MSC_VER
+#define PALM_EXPORT __declspec(dllexport)
+#else
+#define PALM_EXPORT __attribute__((visibility("default")))
+#endif
+#endif
+
+#ifndef PALM_CALL
+#ifdef _MSC_VER
+#define PALM_CALL __stdcall
+#else
+#define PALM_CALL
+#endif
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _PalmIDHandle {
+  void* impl;
+} PalmIDHandle;
+
+/**
+ * A live model that has been decrypted and deserialized once by PalmID_ParseLiveModel
+ * so that it can be matched repeatedly without parsing the model data again.
+ */
+typedef struct _PalmLiveModelHandle {
+  void* impl;
+} PalmLiveModelHandle;
+
+/**
+ * A reference counted set of palm models that several palm biometrics handles can attach to
+ * and match against without holding their own copy of the models.
+ */
+typedef struct _PalmGalleryHandle {
+  void* impl;
+} PalmGalleryHandle;
+
+/**
+ * Possible return values from the various API functions.
+ */
+typedef enum _ePalmStatus {
+  /**
+   * The desired operation completed successfully.
+   */
+  ePalm_Success = 0,
+
+  /**
+   * The function timed-out before completing the desired operation.
+   */
+  ePalm_Timeout = 1,
+
+  /**
+  * Some allocated memory was not freed.
+  */
+  ePalm_MemoryLeak = 2,
+
+  /**
+   * There was an error completing the desired operation, but for an unknown
+   * reasons.
+   */
+  ePalm_UnknownError = 0x8000,
+
+  /**
+   * An operation was requested when it was not expected.
+   */
+  ePalm_InvalidHandle = 0x8001,
+
+  /**
+   * One of the provided arguments was invalid or incomplete.
+   */
+  ePalm_InvalidArgument = 0x8002,
+
+  /**
+   * Insufficient memory in buffer.
+   */
+  ePalm_OutOfMemory = 0x8003,
+
+  /**
+   * An operation was requested when it was not expected.
+   */
+  ePalm_UnexpectedRequest = 0x8004,
+
+  /**
+   * The license id used was invalid.
+   */
+  ePalm_InvalidLicense = 0x8005,
+
+  /**
+   * The model does not exist or is invalid.
+   */
+  ePalm_InvalidModel = 0x8006,
+
+  /**
+   * Error connecting to API server.
+   */
+  ePalm_ServerConnectionError = 0x8007,
+
+  /**
+   * Error in data serialization.
+   */
+  ePalm_SerializationError = 0x8008,
+
+  /**
+   * The message queue is full.
+   */
+  ePalm_QueueFull = 0x8009,
+
+  /**
+   * The request was rejected because too many requests are already pending.
+   */
+  ePalm_Overloaded = 0x800A
+} ePalmStatus;
+
+/**
+* The type of palm to use.
+*/
+typedef enum _PalmType {
+  /**
+  * A visible capture of the palm print.
+  */
+  PalmType_Print = 0,
+
+  /**
+  * An infrared capture of the palm veins.
+  */
+  PalmType_Vein = 1
+} PalmType;
+
+typedef struct _PalmImage {
+  /**
+   * Type of the image.
+   */
+  PalmType type;
+
+  /**
+   * Pointer to the raw image data.
+   */
+  uint8_t* data;
+
+  /**
+   * Bit depth of the image in bits.
+   */
+  uint32_t depth;
+
+  /**
+   * Width of the image in pixels.
+   */
+  uint32_t width;
+
+  /**
+   * Height of the image in pixels.
+   */
+  uint32_t height;
+
+  /**
+   * Size of a row of pixels in bytes, including any padding at end.
+   */
+  uint32_t stride;
+
+  /**
+   * Number of bytes offset from the beginning of data to the start of image.
+   */
+  uint32_t offset;
+
+  /**
+   * The time at which the frame was captured in microseconds.
+   */
+  int64_t timestamp;
+
+  /**
+   * If non-zero, the capturing device has active illumination such as infrared LEDs or torch.
+   */
+  int8_t active_lighting;
+
+  /**
+   * If non-zero, the camera is facing away from the user.
+   */
+  int8_t rear_facing_camera;
+} PalmImage;
+
+/**
+ * A camera device frame.
+ */
+typedef struct _PalmFrame {
+  /**
+  * Number of images associated with this frame.
+  */
+  uint32_t num_images;
+
+  /**
+   * Pointers to images associated with this frame. Support up to 8 images but only the first 'num_images' are allocated and used.
+   */
+  PalmImage* images[8];
+} PalmFrame;
+
+typedef enum _PalmSidedness {
+  /**
+  * The handedness could not be determined
+  */
+  PalmSidedness_Undetermined = -1,
+
+  /**
+  * The palm is a left hand
+  */
+  PalmSidedness_Left = 0,
+
+  /**
+  * The palm is a right hand
+  */
+  PalmSidedness_Right = 1
+} PalmSidedness;
+
+/**
+* Strictness refers to how accurately the palm needs to be aligned to the guide, as well as other criteria,
+* in order to capture it.  A higher strictness means more accurate matching, but may be more difficult for
+* a user to position their hand for capture.  A lower strictness means a palm can be placed in more places
+* within the camera's field of view, but matching accuracy may be lower.
+*/
+typedef enum _PalmStrictness {
+  /**
+  * The palm cannot be captured.
+  */
+  PalmStrictness_None = -1,
+
+  /**
+  * The minimum possible strictness to capture a palm. (1/5)
+  */
+  PalmStrictness_Minimum = 0,
+
+  /**
+  * A high strictness criterion recommended for palm authentication captures. (2/5)
+  */
+  PalmStrictness_Authenticate = 1,
+
+  /**
+  * A medium strictness to capture a palm. (3/5)
+  */
+  PalmStrictness_Medium = 2,
+
+  /**
+  * A high strictness requirement recommended for palm enrollment captures. (4/5)
+  */
+  PalmStrictness_Enrollment = 3,
+
+  /**
+  * The maximum possible strictness to capture a palm. (5/5)
+  */
+  PalmStrictness_Maximum = 4
+} PalmStrictness;
+
+typedef enum _PalmLiveness {
+  /**
+  * No liveness is preformed.
+  */
+  PalmLiveness_None = 0,
+
+  /**
+  * After palm capture, user is prompted to make a fist.
+  */
+  PalmLiveness_Fist = 1,
+
+  /**
+  * After palm capture, a high-resolution image with active lighting is captured.
+  */
+  PalmLiveness_HiRes = 2,
+
+  /**
+  * Combination of PalmLiveness_HiRes followed by PalmLiveness_Fist.
+  */
+  PalmLiveness_HiRes_Fist = 3,
+} PalmLiveness;
+
+/**
+* The encoding of a serialized palm model. Every serialized model starts with a version header,
+* so functions accepting model data accept all encodings.
+*/
+typedef enum _PalmModelEncoding {
+  /**
+  * The original encoding with full precision features.
+  */
+  PalmModelEncoding_Legacy = 0,
+
+  /**
+  * A compact encoding with quantized, entropy-coded features. Decoding is faster than matching.
+  */
+  PalmModelEncoding_CompactV1 = 1
+} PalmModelEncoding;
+
+typedef struct _PalmModelID {
+  /**
+   * Unique identifier for palm model
+   */
+  uint8_t id[20];
+} PalmModelID;
+
+/**
+ * A 2-D point.
+ */
+typedef struct _PalmPoint2D {
+  float x;
+  float y;
+} PalmPoint2D;
+
+/**
+ * A 2-D quadrilateral described by four 2-D points.
+ */
+typedef struct _PalmQuad2D {
+  PalmPoint2D a;
+  PalmPoint2D b;
+  PalmPoint2D c;
+  PalmPoint2D d;
+} PalmQuad2D;
+
+typedef struct _PalmDetected {
+  /**
+   * A quadrilateral in image coordinates enclosing the palm.
+   */
+  PalmQuad2D quad;
+
+  /**
+   * Timestamp of when image with detected palm was captured in microseconds.
+   */
+  int64_t timestamp;
+
+  /**
+   * The highest strictness level that the palm could be immediately captured.
+   * If no palm can be captured, this value will be PalmStrictness_None.
+   */
+  PalmStrictness readiness;
+
+  /**
+   * The quality of the palm.
+   */
+  float quality;
+
+  /**
+   * The brightness of the palm.
+   */
+  float brightness;
+
+  /**
+   * The centerness of the palm.
+   */
+  float centerness;
+
+  /**
+   * A scaler between 0 and 1 to indicate the likelihood of the detected palm being left or right (0 is definitely left and 1 is definitely right).
+   */
+  float sidedness;
+} PalmDetected;
+
+/**
+ * The palms detected in the latest frame.
+ */
+typedef struct _PalmsDetected {
+  /**
+   * The number of palms detected.
+   */
+  uint32_t num_palms;
+
+  /**
+   * An array of detected palms, consisting of num_detected palms.
+   */
+  PalmDetected* palms;
+} PalmsDetected;
+
+/**
+ * An individual matching result.
+ */
+typedef struct _PalmMatch {
+  /**
+   * The id of the previously registered model that is matched.
+   */
+  PalmModelID matched_id;
+
+  /**
+   * The matching score.
+   */
+  float score;
+
+  /**
+   * When the current live scan and previously registered model matches,
+   * the registered model may be updated if the update_model flag was set
+   * to true when PalmID_Match is called. When the model is updated, this
+   * field will be non-zero. In this case, use PalmID_GetModel to retrieve
+   * and save the updated model for future usage, or enable the
+   * "inline_updated_model" configuration to receive it in
+   * PalmMatchingResult.updated_models.
+   */
+  uint8_t updated;
+} PalmMatch;
+
+/**
+ * The matching result.
+ *
+ * The fields after 'matches' were added in a later release. They are set in results produced by the SDK,
+ * but ignored by PalmID_QueueMessage, whose caller may have been built against the shorter structure.
+ */
+typedef struct _PalmMatchingResult {
+  /**
+   * The id of the current live model scan.
+   */
+  PalmModelID live_id;
+
+  /**
+   * The type of matching used.
+   */
+  PalmType type;
+
+  /**
+   * The number of palms that passed matching.
+   */
+  int32_t num_matches;
+
+  /**
+   * An array of num_matches matching results. Only matches with score above
+   * the requested threshold are returned.
+   */
+  PalmMatch* matches;
+
+  /**
+   * An array of num_matches updated models, indexed like matches. This is only set when the
+   * "inline_updated_model" configuration is enabled, otherwise it is null. An entry holds the
+   * same data as the PalmGetModelResult of PalmID_GetModel when the 'updated' flag of the
+   * corresponding match is non-zero, and has null data otherwise. It is freed together with
+   * the message.
+   */
+  struct _PalmGetModelResult* updated_models;
+
+  /**
+   * The request_tag passed to the match function that produced this result, so that several requests
+   * pending for the same live model can be told apart. This is 0 for results of PalmID_Match.
+   */
+  uint64_t request_tag;
+
+  /**
+   * The number of requested models that could not be scored because their data is corrupt, such as a model
+   * that fails to decode with "lazy_models" enabled or a gallery template that fails authentication. These
+   * models are not among the matches, so a non-zero count means that the absence of a match is not conclusive.
+   */
+  int32_t num_skipped;
+} PalmMatchingResult;
+
+/**
+ * The capture result.
+ */
+typedef struct _PalmCaptureResult {
+  /**
+   * A unique identifier for the captured palm
+   */
+  PalmModelID model_id;
+
+  /**
+   * A flag to indicate if palm model is for left or right.
+   */
+  PalmSidedness sidedness;
+
+  /**
+   * A bitcode to indicate palm type. 0-Unknown, 1-Print, 2-Vein, 3-Print and Vein
+   */
+  uint8_t type;
+
+  /**
+   * A pointer to the data stream for this model. This will be null if capture failed.
+   */
+  void* data;
+
+  /**
+  * The size of the model data in bytes. This will be 0 if capture failed.
+  */
+  uint32_t data_size;
+} PalmCaptureResult;
+
+typedef enum _PalmLivenessStatus {
+  /**
+  * It could not be determined if the detected palm is a live one or not.
+  */
+  PalmLivenessStatus_Undetermined = -1,
+
+  /**
+  * The palm passes the liveness check.
+  */
+  PalmLivenessStatus_Pass = 0,
+
+  /**
+  * The palm fails the liveness check.
+  */
+  PalmLivenessStatus_Fail = 1,
+
+  /**
+  * The palm fails because the background is too bright.
+  */
+  PalmLivenessStatus_Fail_Background = 2
+} PalmLivenessStatus;
+
+/**
+* The liveness check result.
+*/
+typedef struct _PalmLivenessResult {
+  /**
+  * The liveness check status;
+  */
+  PalmLivenessStatus status;
+
+  /**
+  * The model id of the palm
+  */
+  PalmModelID model_id;
+} PalmLivenessResult;
+
+/**
+* The GetModel result.
+*/
+typedef struct _PalmGetModelResult {
+  /**
+   * The id of the requested model
+   */
+  PalmModelID model_id;
+
+  /**
+   * A pointer to the data stream for this model. This will be null if no model was found.
+   */
+  void* data;
+
+  /**
+  * The size of the model data in bytes. This will be 0 if no model was found.
+  */
+  uint32_t data_size;
+} PalmGetModelResult;
+
+/**
+ * The possible message types.
+ */
+typedef enum _ePalmMessageType {
+  /**
+   * No message was available.
+   */
+  MessageNone = 0,
+
+  /**
+   * The message corresponds to palms being detected.
+   */
+  MessagePalmsDetected = 1,
+
+  /**
+   * The message corresponds to palm matching result.
+   */
+  MessageMatchingResult = 2,
+
+  /**
+   * The message corresponds to palm capture result.
+   */
+  MessageCaptureResult = 3,
+
+  /**
+   * The message corresponds to palm matching started.
+   */
+  MessageMatchingStarted = 4,
+
+  /**
+   * The message corresponds to palm matching finished.
+   */
+  MessageMatchingFinished = 5,
+
+  /**
+   * The message corresponds to palm capture started.
+   */
+  MessageCaptureStarted = 6,
+
+  /**
+   * The message corresponds to palm capture finished.
+   */
+  MessageCaptureFinished = 7,
+
+  /**
+   * The message corresponds to add palm model.
+   */
+  MessageAddModelResult = 9,
+
+  /**
+   * The message corresponds to remove palm model.
+   */
+  MessageRemoveModelResult = 10,
+
+  /**
+  * The message corresponds to palm liveness check result.
+  */
+  MessageLivenessResult = 11,
+
+  /**
+  * The message corresponds to palm liveness check started.
+  */
+  MessageLivenessStarted = 12,
+
+  /**
+  * The message corresponds to palm liveness check finished.
+  */
+  MessageLivenessFinished = 13,
+
+  /**
+  * The message corresponds to get model result.
+  */
+  MessageGetModelResult = 14,
+
+  /**
+  * The message corresponds to add multiple palm models.
+  */
+  MessageAddModelsResult = 15,
+
+  /**
+  * The message corresponds to remove multiple palm models.
+  */
+  MessageRemoveModelsResult = 16,
+
+  /**
+  * The message corresponds to a palm model removed from the database by the SDK.
+  */
+  MessageModelEvicted = 17
+} ePalmMessageType;
+
+/**
+ * The bit of a message type in a message filter, see 'PalmID_SetMessageFilter'.
+ */
+#define PALM_MESSAGE_MASK(type) (1u << (uint32_t)(type))
+
+/**
+ * A message filter that accepts every message type.
+ */
+#define PALM_MESSAGE_MASK_ALL 0xFFFFFFFFu
+
+/**
+ * The result of a request to add a palm model
+ */
+typedef struct _PalmAddModelResult {
+  /**
+   * The ID of the model that was attempted to be added.
+   */
+  PalmModelID model_id;
+
+  /**
+   * Non-zero if the model was successfully added to the database.
+   */
+  uint8_t success;
+} PalmAddModelResult;
+
+/**
+* The result of a request to remove a palm model
+*/
+typedef struct _PalmRemoveModelResult {
+  /**
+  * The ID of the model that was attempted to be removed.
+  */
+  PalmModelID model_id;
+
+  /**
+  * Non-zero if the model was successfully removed from the database.
+  */
+  uint8_t success;
+} PalmRemoveModelResult;
+
+/**
+* The result of a request to add or remove multiple palm models
+*/
+typedef struct _PalmBulkModelResult {
+  /**
+  * The number of models in the request.
+  */
+  int32_t num_models;
+
+  /**
+  * The number of models that were successfully added to or removed from the database.
+  */
+  int32_t num_succeeded;
+
+  /**
+  * An array of num_models model IDs, in the same order as the request.
+  */
+  PalmModelID* model_ids;
+
+  /**
+  * An array of num_models flags, in the same order as the request. A flag is non-zero if the
+  * corresponding model was successfully added or removed.
+  */
+  uint8_t* success;
+} PalmBulkModelResult;
+
+/**
+* A palm model that the SDK removed from the database on its own, such as a model found corrupt when decoded
+* with "lazy_models" enabled. The status of the message gives the reason, e.g. ePalm_InvalidModel.
+*/
+typedef struct _PalmModelEvicted {
+  /**
+  * The ID of the model that was removed.
+  */
+  PalmModelID model_id;
+} PalmModelEvicted;
+
+typedef struct _PalmMessage {
+  /**
+   * The message type of this message.
+   */
+  ePalmMessageType type;
+
+  /**
+   * The error status. If the value is not ePalm_Success, then an error occurs when the message is generated.
+   */
+  ePalmStatus status;
+
+  /**
+   * A pointer to the message corresponding to the message type. The message and everything it points to,
+   * such as arrays of palms or matches and model data streams, are allocated in a single block that is
+   * released by PalmID_FreeMessage. These pointers must not be freed individually or used after the
+   * message is freed.
+   */
+  union {
+    void* pointer;
+    PalmsDetected* palms_detected;
+    PalmCaptureResult* capture_result;
+    PalmMatchingResult* matching_result;
+    PalmLivenessResult* liveness_result;
+    PalmAddModelResult* add_model_result;
+    PalmRemoveModelResult* remove_model_result;
+    PalmGetModelResult* get_model_result;
+    PalmBulkModelResult* add_models_result;
+    PalmBulkModelResult* remove_models_result;
+    PalmModelEvicted* model_evicted;
+  } message;
+} PalmMessage;
+
+/**
+ * The value of PalmWireHeader.magic ("PMSG" in little-endian byte order).
+ */
+#define PALM_WIRE_MAGIC 0x47534D50u
+
+/**
+ * The message wire format version written by this SDK.
+ */
+#define PALM_WIRE_VERSION 1u
+
+/**
+ * The header of a message encoded by 'PalmMessage_Serialize'.
+ *
+ * The wire format does not depend on the layout of the native structures, and is the same for 32-bit and
+ * 64-bit builds. The 16-byte header is followed by payload_size bytes whose layout depends on the message
+ * type, given below as byte offsets from the start of the payload. Integers are little-endian, floats are
+ * little-endian IEEE 754 binary32, ids are the 20 bytes of a PalmModelID, and reserved bytes are 0.
+ *
+ *   MessagePalmsDetected:   0 num_palms (u32), 4 num_palms records of 60 bytes:
+ *                             0 quad a.x a.y b.x b.y c.x c.y d.x d.y (8 x f32), 32 timestamp (i64),
+ *                             40 readiness (i32), 44 quality (f32), 48 brightness (f32), 52 centerness (f32),
+ *                             56 sidedness (f32)
+ *   MessageMatchingResult:  0 live_id, 20 type (i32), 24 num_matches (i32), 28 flags (u32, bit 0 set if updated
+ *                           models follow), 32 request_tag (u64), 40 num_skipped (i32), 44 reserved (4 bytes),
+ *                           48 num_matches records of 28 bytes:
+ *                             0 matched_id, 20 score (f32), 24 updated (u8), 25 reserved (3 bytes)
+ *                           then, if flags bit 0 is set, for each match in order: data_size (u32) followed by
+ *                           data_size bytes of updated model data (0 if the model was not updated)
+ *   MessageCaptureResult:   0 model_id, 20 sidedness (i32), 24 type (u8), 25 reserved (3 bytes),
+ *                           28 data_size (u32), 32 data_size bytes of model data
+ *   MessageLivenessResult:  0 status (i32), 4 model_id
+ *   MessageAddModelResult,
+ *   MessageRemoveModelResult: 0 model_id, 20 success (u8), 21 reserved (3 bytes)
+ *   MessageModelEvicted:    0 model_id
+ *   MessageGetModelResult:  0 model_id, 20 data_size (u32), 24 data_size bytes of model data
+ *   MessageAddModelsResult,
+ *   MessageRemoveModelsResult: 0 num_models (i32), 4 num_succeeded (i32), 8 num_models ids,
+ *                           8 + 20 * num_models: num_models success flags (u8)
+ *   Other message types:    no payload
+ */
+typedef struct _PalmWireHeader {
+  /**
+   * Must be PALM_WIRE_MAGIC.
+   */
+  uint32_t magic;
+
+  /**
+   * The wire format version, PALM_WIRE_VERSION for messages encoded by this SDK.
+   */
+  uint16_t version;
+
+  /**
+   * The ePalmMessageType of the message.
+   */
+  uint16_t type;
+
+  /**
+   * The ePalmStatus of the message.
+   */
+  uint32_t status;
+
+  /**
+   * The number of bytes following this header.
+   */
+  uint32_t payload_size;
+} PalmWireHeader;
+
+/**
+ * The value of PalmGalleryHeader.magic ("PGAL" in little-endian byte order).
+ */
+#define PALM_GALLERY_MAGIC 0x4C414750u
+
+/**
+ * The gallery file format version written by this SDK.
+ */
+#define PALM_GALLERY_VERSION 1u
+
+/**
+ * The header at the start of a gallery file written by 'PalmID_WriteGallery'.
+ *
+ * A gallery file consists of this header, followed by num_models fixed-size templates of template_stride
+ * bytes each starting at templates_offset, followed by num_models PalmModelIDs starting at index_offset.
+ * The i-th id of the index identifies the i-th template. All values are little-endian and every section
+ * is aligned to 64 bytes, so that the file can be memory mapped without copying or deserializing it.
+ *
+ * Templates are never stored in plaintext. Each template is encrypted with AES-256-GCM, using a key derived
+ * from the "encryption_key" configuration and its model id as associated data, and is stored as a 12-byte
+ * nonce, the ciphertext and a 16-byte authentication tag, padded to template_stride.
+ *
+ * The header has the same size and layout, without padding, in 32-bit and 64-bit builds.
+ */
+typedef struct _PalmGalleryHeader {
+  /**
+   * Must be PALM_GALLERY_MAGIC.
+   */
+  uint32_t magic;
+
+  /**
+   * The file format version, PALM_GALLERY_VERSION for files written by this SDK.
+   */
+  uint32_t version;
+
+  /**
+   * The PalmModelEncoding of the templates, see the "model_encoding" configuration.
+   */
+  uint32_t encoding;
+
+  /**
+   * Reserved, must be 0.
+   */
+  uint32_t flags;
+
+  /**
+   * The number of models in the gallery.
+   */
+  uint64_t num_models;
+
+  /**
+   * The size of a single template in bytes, including any padding at end.
+   */
+  uint64_t template_stride;
+
+  /**
+   * Number of bytes offset from the beginning of the file to the first template.
+   */
+  uint64_t templates_offset;
+
+  /**
+   * Number of bytes offset from the beginning of the file to the model id index.
+   */
+  uint64_t index_offset;
+
+  /**
+   * A bitcode of the palm types present in the templates, as in PalmCaptureResult.type.
+   */
+  uint8_t palm_types;
+
+  /**
+   * Reserved, must be 0.
+   */
+  uint8_t reserved[3];
+
+  /**
+   * The CRC-32C of this header, computed with this field set to 0, followed by the model id index.
+   * Templates are covered by their authentication tags instead.
+   */
+  uint32_t checksum;
+
+  /**
+   * A value derived from the encryption key, used to detect that a gallery was written with another key.
+   */
+  uint8_t key_check[16];
+} PalmGalleryHeader;
+
+/**
+ * Counters of the decoded template cache of a handle or of a shared gallery, see the "memory_budget" and
+ * "gallery_memory_budget" configurations.
+ */
+typedef struct _PalmCacheStats {
+  /**
+   * The number of times a matched model was already decoded.
+   */
+  uint64_t hits;
+
+  /**
+   * The number of times a matched model had to be decoded.
+   */
+  uint64_t misses;
+
+  /**
+   * The number of decoded models evicted to stay within the memory budget.
+   */
+  uint64_t evictions;
+
+  /**
+   * The number of bytes currently used by decoded models.
+   */
+  uint64_t bytes_used;
+} PalmCacheStats;
+
+/**
+ * The memory used by a handle, in bytes, broken down by category.
+ */
+typedef struct _PalmMemoryStats {
+  /**
+   * Memory used by frame processing and palm detection buffers.
+   */
+  uint64_t detection_bytes;
+
+  /**
+   * Memory used by messages that are queued or were returned and not yet freed.
+   */
+  uint64_t message_bytes;
+
+  /**
+   * Memory used by the models added to the handle, including decoded templates and indices, and the lookup
+   * structures built for a gallery file mapped with PalmID_MapGallery. The pages of the mapped file are not included, since they
+   * are shared with other mappings. An attached shared gallery is reported by 'PalmGallery_GetMemoryStats'.
+   */
+  uint64_t model_bytes;
+
+  /**
+   * Memory used by the handle for any other purpose.
+   */
+  uint64_t other_bytes;
+
+  /**
+   * The sum of all categories above.
+   */
+  uint64_t total_bytes;
+
+  /**
+   * The highest value of total_bytes since the handle was created.
+   */
+  uint64_t peak_bytes;
+} PalmMemoryStats;
+
+/**
+ * The memory used by a shared gallery, in bytes, broken down by category. This memory is used once per
+ * process, however many handles the gallery is attached to.
+ */
+typedef struct _PalmGalleryMemoryStats {
+  /**
+   * Memory used by the model data streams added with PalmGallery_AddModels.
+   */
+  uint64_t model_bytes;
+
+  /**
+   * Memory used by the decoded template cache, see "gallery_memory_budget".
+   */
+  uint64_t decoded_bytes;
+
+  /**
+   * Memory used by the model id lookup structures and, with "sidedness_partitioning", the partitions.
+   */
+  uint64_t index_bytes;
+
+  /**
+   * The size of the gallery file mapped with PalmGallery_Map, or 0. Its pages are backed by the file and
+   * shared with other processes mapping it, so they may be resident only in part.
+   */
+  uint64_t mapped_bytes;
+
+  /**
+   * The sum of model_bytes, decoded_bytes and index_bytes, i.e. the memory that is not backed by a file.
+   */
+  uint64_t total_bytes;
+
+  /**
+   * The highest value of total_bytes since the gallery was created.
+   */
+  uint64_t peak_bytes;
+} PalmGalleryMemoryStats;
+
+/**
+ * Statistics of the message queue of a handle. Latencies are in nanoseconds.
+ */
+typedef struct _PalmQueueStats {
+  /**
+   * The number of messages added to the queue, including messages passed directly to a callback
+   * registered with PalmID_SetMessageCallback.
+   */
+  uint64_t enqueued;
+
+  /**
+   * The number of messages delivered, i.e. returned by PalmID_WaitMessage or PalmID_WaitMessages or
+   * passed to a message callback.
+   */
+  uint64_t dequeued;
+
+  /**
+   * The number of messages that could not be added because the queue was full.
+   */
+  uint64_t dropped;
+
+  /**
+   * The median and 99th percentile time taken to add a message to the queue.
+   */
+  uint64_t enqueue_latency_p50;
+  uint64_t enqueue_latency_p99;
+
+  /**
+   * The median and 99th percentile time between a message being added to the queue and being
+   * delivered, i.e. returned by PalmID_WaitMessage or PalmID_WaitMessages or passed to a message
+   * callback.
+   */
+  uint64_t delivery_latency_p50;
+  uint64_t delivery_latency_p99;
+} PalmQueueStats;
+
+/**
+ * A function called with a message instead of adding it to the message queue, see 'PalmID_SetMessageCallback'.
+ * The callback takes ownership of the message, which should be freed after use with 'PalmID_FreeMessage'.
+ */
+typedef void (PALM_CALL *PalmMessageCallback)(PalmIDHandle handle, PalmMessage message, void* user_data);
+
+/**
+ * A function running 'task(task_data)' on a thread of the caller's choice, see 'PalmID_SetMessageExecutor'.
+ */
+typedef void (PALM_CALL *PalmExecutor)(void (PALM_CALL *task)(void* task_data), void* task_data, void* executor_data);
+
+/**
+ * Set configuration parameters. A parameter is specified by two strings [name, value].
+ * Call this function before calling PalmID_Create.
+ *
+ * @param key A pointer to parameter name string. The string is expected to end with '\0'.
+ * @param value A pointer to parameter value string. The string is expected to end with '\0'.
+ *
+ * For possible key values, see 'PalmID_GetConfig'.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_SetConfig(const char* key, const char* value);
+
+/**
+ * Get configuration parameters.
+ *
+ * @param key A pointer to parameter name string. The string is expected to end with '\0'.
+ * @param value A pointer to hold the output parameter value string. The caller needs to allocate the memory.
+ * @param value_size A pointer to an integer to hold the output parameter value string size. This parameter
+ * is updated upon return with the actual number of bytes written to the value pointer.
+ * @param null_terminate A boolean value on whether or not to include a null-termination character ('\0') at
+ * the end of the value string (0 is no, otherwise yes).
+ *
+ * @note: If the size of the value buffer is insufficient to hold the entire value, this function will
+ * return an ePalm_InsufficientMemory error, and the value_size parameter will be updated with the actual
+ * size needed to store the results.
+ *
+ * Possible keys include:
+ *   "version":         The full version number of the SDK and build (read-only).
+ *   "major_version":   The major version number of the SDK (read-only).
+ *   "minor_version":   The minor version number of the SDK (read-only).
+ *   "license_id":      The license id required for authentication.
+ *   "encryption_key":  A string used to encrypt/decrypt models.
+ *   "rotation_angle":  Rotation of the palm in degrees.  Fingers pointing up in the image is 0 degrees
+ *                      and increases clockwise to 360 degrees.  Negative angles are okay as well.
+ *                      The value "auto" may also be used so the SDK can automatically choose the angle.
+ *   "inline_updated_model": "1" to serialize models updated by a match into PalmMatchingResult.updated_models,
+ *                      so that no PalmID_GetModel request is needed to persist them. Default is "0".
+ *   "model_encoding":  The encoding of models produced by capture, PalmID_GetModel and updated matches.
+ *                      Either "legacy" or "compact" (see PalmModelEncoding). Default is "legacy".
+ *   "crypto_acceleration": "auto" to decrypt models with the CPU crypto extensions (ARMv8 Cryptography
+ *                      Extensions or AES-NI) when available, or "none" to always use the portable
+ *                      implementation. Default is "auto".
+ *   "crypto_implementation": The model decryption implementation in use, "armv8", "aesni" or "portable"
+ *                      (read-only).
+ *   "decrypt_throughput": The average model decryption throughput in MB/s since the SDK was loaded
+ *                      (read-only).
+ *   "lazy_models":     "1" to only validate the header of a model when it is added, and decode it the first
+ *                      time it is matched (once, even if several matches use it concurrently). A model that
+ *                      fails to decode is skipped by that match, which otherwise completes normally and counts
+ *                      it in PalmMatchingResult.num_skipped, and is removed from the database; a
+ *                      MessageModelEvicted with the status ePalm_InvalidModel is then produced for it.
+ *                      Default is "0".
+ *   "memory_budget":   The maximum number of bytes of decoded models kept by a handle. When exceeded, the least
+ *                      recently matched models are evicted and decoded again from their model data, or from the
+ *                      mapped gallery file, when next matched. Models of an attached shared gallery are kept in
+ *                      the gallery's cache instead. "0" means unlimited. Default is "0".
+ *   "gallery_memory_budget": The maximum number of bytes of decoded models kept by a shared gallery created
+ *                      afterwards with PalmGallery_Create. The gallery has a single cache used by all handles it
+ *                      is attached to, so this memory does not grow with the number of handles. Eviction works
+ *                      as for "memory_budget". "0" means unlimited. Default is "0".
+ *   "sidedness_partitioning": "1" to partition the model database by sidedness and palm type, so that PalmID_Match
+ *                      skips models of the other hand when the sidedness of the live model is confident, and
+ *                      models without the requested palm type. Models of undetermined sidedness are always
+ *                      matched. Default is "0".
+ *   "sidedness_confidence": The confidence in [0.5, 1] above which the sidedness of a live model is used to
+ *                      select a partition. Default is "0.9".
+ *   "message_queue_capacity": The maximum number of messages in the message queue of a handle, or "0" for no
+ *                      limit. When the queue is full, new MessagePalmsDetected messages are dropped, other
+ *                      messages produced by the SDK wait for space, and PalmID_QueueMessage returns
+ *                      ePalm_QueueFull. Messages passed to a callback do not occupy the queue. Default is "0".
+ *   "message_arena_size": The number of bytes each handle reserves up front for message payloads. Messages are
+ *                      allocated from a per-handle arena that grows on demand and reuses the blocks of freed
+ *                      messages, so that in steady state no allocation is made per message. Reserving memory
+ *                      up front only avoids the first allocations. Default is "0".
+ *   "message_priority": "results" to return result messages (MessageMatchingResult, MessageCaptureResult,
+ *                      MessageLivenessResult, MessageGetModelResult and the add/remove model results) before any
+ *                      other queued message, or "fifo" to return all messages in order. Default is "fifo".
+ *   "coalesce_detections": "1" to keep only the latest MessagePalmsDetected in the message queue, replacing
+ *                      older ones that have not been returned yet. Default is "0".
+ *   "max_pending_matches": The maximum number of live models a handle accepts for matching before their results
+ *                      are produced. A call to PalmID_MatchBatch counts as num_lives requests and is accepted or
+ *                      rejected as a whole. Further requests are rejected with ePalm_Overloaded instead of being
+ *                      queued. "0" means unlimited. Default is "0".
+ *   "match_timeout": The number of milliseconds after which a match request gives up, counted from the call that
+ *                      made it, or "0" for no limit. Applies to every match function, including PalmID_Match; for
+ *                      PalmID_MatchUntil and PalmID_MatchBatch the earlier of this and their deadline applies. A
+ *                      request that times out produces a PalmMatchingResult with the status ePalm_Timeout holding
+ *                      the matches found before. Default is "0".
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_GetConfig(const char* key, char* value, int32_t* value_size, int null_terminate);
+
+/**
+ * Create a new palm biometrics handle that is passed to most of the Palm biometrics
+ * functions.
+ *
+ * @param handle A pointer to a palm biometrics handle.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_Create(PalmIDHandle* handle);
+
+/**
+ * Destroy a palm biometrics handle.
+ *
+ * @param handle A palm biometrics handle.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_Destroy(PalmIDHandle* handle);
+
+/**
+ * Current time in microseconds.
+ *
+ * @return The current time in microseconds. A negative value indicates failure.
+ */
+PALM_EXPORT int64_t PALM_CALL PalmID_Now(void);
+
+/**
+ * Provide a camera frame for processing.
+ *
+ * @param handle A palm biometrics handle.
+ * @param frame The frame acquired through the Camera SDK or from an
+ *              alternate image-capture interface.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_ProcessFrame(PalmIDHandle handle, const PalmFrame* frame);
+
+/**
+ * Attempt to create a new palm model that will extracted from the frame sequence provided
+ * by PalmID_ProcessFrame(). The new model will be returned as a PalmCaptureResult.
+ *
+ * @param handle A palm biometrics handle.
+ * @param strictness The strictness criterion for a palm capture.
+ * @param liveness Liveness criterion for a successful palm capture.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_Capture(PalmIDHandle handle, PalmStrictness strictness, PalmLiveness liveness);
+
+/**
+* Obtains a serialized model that can be saved to disk for future matches.
+* After calling this function, the model will be returned in a GetModelResult message.
+*
+* @param handle A palm biometrics handle.
+* @param model_id A palm model ID for the desired palm model.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_GetModel(PalmIDHandle handle, const PalmModelID* model_id);
+
+/**
+* Convert a serialized model to another encoding, for example to re-encode previously stored models
+* with PalmModelEncoding_CompactV1. The model stays encrypted with the configured "encryption_key".
+*
+* @param model_data A pointer to palm model data stream.
+* @param model_data_size The size of palm model data stream in bytes.
+* @param encoding The encoding of the converted model.
+* @param output A pointer to hold the converted model data stream. The caller needs to allocate the memory.
+* @param output_size A pointer to an integer to hold the output size. This parameter is updated upon return
+* with the actual number of bytes written to the output pointer.
+*
+* @note: If the size of the output buffer is insufficient to hold the converted model, this function will
+* return an ePalm_OutOfMemory error, and the output_size parameter will be updated with the actual size
+* needed to store the results.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_ConvertModel(const void* model_data, uint32_t model_data_size, PalmModelEncoding encoding, void* output, uint32_t* output_size);
+
+/**
+ * Attempt to add a newly created palm model if it doesn't already exist so that it is
+ * available for matching. When "lazy_models" is enabled, the model is decoded on its first match and a
+ * successful MessageAddModelResult only means that its header is valid.
+ *
+ * @param handle A palm biometrics handle.
+ * @param model_data A pointer to palm model data stream.
+ * @param model_data_size The size of palm model data stream in bytes.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_AddModel(PalmIDHandle handle, const void* model_data, uint32_t model_data_size);
+
+/**
+* Attempt to remove an existing palm model so that it is no longer available for matching.
+*
+* @param handle A palm biometrics handle.
+* @param model_id Pointer to the id of the model to be removed.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_RemoveModel(PalmIDHandle handle, const PalmModelID* model_id);
+
+/**
+ * Attempt to add several palm models at once. This is equivalent to calling PalmID_AddModel for
+ * every model, but the model database is locked and its indices are rebuilt only once, and a single
+ * PalmBulkModelResult is returned in a MessageAddModelsResult message instead of one message per model.
+ * When an "encryption_key" is configured, the models are decrypted in batches rather than one at a time.
+ * All models are published to matching at once, in a single new version of the model database.
+ *
+ * @param handle A palm biometrics handle.
+ * @param model_data An array of num_models pointers to palm model data streams.
+ * @param model_data_sizes An array of num_models sizes of the palm model data streams in bytes.
+ * @param num_models The number of models to add.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_AddModels(PalmIDHandle handle, const void* const* model_data, const uint32_t* model_data_sizes, int32_t num_models);
+
+/**
+* Attempt to remove several existing palm models at once. The result is returned as a single
+* PalmBulkModelResult in a MessageRemoveModelsResult message. Matches already in progress may still
+* match the removed models.
+*
+* @param handle A palm biometrics handle.
+* @param model_ids An array of num_model_ids ids of the models to be removed.
+* @param num_model_ids The number of models to remove.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_RemoveModels(PalmIDHandle handle, const PalmModelID* model_ids, int32_t num_model_ids);
+
+/**
+ * Write all models currently available for matching to a gallery file (see PalmGalleryHeader). Templates are
+ * written with the configured "model_encoding" and encrypted with the configured "encryption_key".
+ * This function completes synchronously and does not produce a message.
+ *
+ * @param handle A palm biometrics handle.
+ * @param path A pointer to the file path string. The string is expected to end with '\0'. An existing
+ *             file is replaced.
+ *
+ * @return ePalm_InvalidArgument if no "encryption_key" is configured.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_WriteGallery(PalmIDHandle handle, const char* path);
+
+/**
+ * Memory map a gallery file written by 'PalmID_WriteGallery' so that its models are available for matching.
+ * The file is neither copied nor deserialized, so mapping takes constant time, and the mapped pages, which
+ * only hold encrypted templates, are shared with any other process mapping the same file. A template is
+ * decrypted and decoded when it is first matched and is then kept in the decoded template cache (see
+ * "memory_budget"). A template that fails authentication is skipped by matches and counted in
+ * PalmMatchingResult.num_skipped. Models of the gallery can be
+ * matched by their ids like any model added with PalmID_AddModel, but they cannot be removed individually.
+ * This function completes synchronously and does not produce a message.
+ *
+ * @param handle A palm biometrics handle.
+ * @param path A pointer to the file path string. The string is expected to end with '\0'.
+ *
+ * @return ePalm_SerializationError if the file is not a valid gallery file, its version or encoding is not
+ *         supported, or its checksum does not match. ePalm_InvalidModel if it was written with another
+ *         "encryption_key".
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_MapGallery(PalmIDHandle handle, const char* path);
+
+/**
+ * Unmap the gallery file mapped with 'PalmID_MapGallery'. Its models are no longer available for matching
+ * once pending matches finish. Destroying the handle also unmaps the gallery.
+ *
+ * @param handle A palm biometrics handle.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_UnmapGallery(PalmIDHandle handle);
+
+/**
+ * Save a snapshot of the model database of a handle, including its indices, to a file in a single
+ * sequential write. Models of a mapped gallery are not included in the snapshot. The snapshot is
+ * encrypted and authenticated as a whole with AES-256-GCM, using a key derived from the "encryption_key"
+ * configuration, so that neither models nor indices are stored in plaintext.
+ * This function completes synchronously and does not produce a message.
+ *
+ * @param handle A palm biometrics handle.
+ * @param path A pointer to the file path string. The string is expected to end with '\0'. An existing
+ *             file is replaced.
+ *
+ * @return ePalm_InvalidArgument if no "encryption_key" is configured.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_SaveSnapshot(PalmIDHandle handle, const char* path);
+
+/**
+ * Restore the model database of a handle from a snapshot written by 'PalmID_SaveSnapshot', replacing the
+ * models previously added to the handle. The snapshot is read in bulk and its indices are used as is, so
+ * no model needs to be added again with PalmID_AddModel.
+ * This function completes synchronously and does not produce a message.
+ *
+ * @param handle A palm biometrics handle.
+ * @param path A pointer to the file path string. The string is expected to end with '\0'.
+ *
+ * @return ePalm_SerializationError if the file is not a valid snapshot, fails authentication or was written
+ *         by an incompatible SDK version, and ePalm_InvalidModel if it was written with another
+ *         "encryption_key". In these cases the model database is left unchanged.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_LoadSnapshot(PalmIDHandle handle, const char* path);
+
+/**
+ * Get the counters of the decoded template cache of a handle. Matches of models of an attached shared gallery
+ * use the gallery's cache and are reported by 'PalmGallery_GetCacheStats' instead.
+ *
+ * @param handle A palm biometrics handle.
+ * @param stats A pointer to a PalmCacheStats to write into.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_GetCacheStats(PalmIDHandle handle, PalmCacheStats* stats);
+
+/**
+ * Get the memory currently used by a handle. Messages not freed when the handle is destroyed are
+ * reported by PalmID_Destroy as ePalm_MemoryLeak.
+ *
+ * @param handle A palm biometrics handle.
+ * @param stats A pointer to a PalmMemoryStats to write into.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_GetMemoryStats(PalmIDHandle handle, PalmMemoryStats* stats);
+
+/**
+ * Create a new empty shared gallery. The gallery is created with a single reference, owned by the
+ * caller, that must be released with 'PalmGallery_Release'.
+ *
+ * A shared gallery owns its models and a single decoded template cache, limited by "gallery_memory_budget",
+ * that every attached handle matches against. Attaching the gallery to more handles, e.g. one per worker
+ * thread, does not copy or decode its models again.
+ *
+ * @param gallery A pointer to a shared gallery handle.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmGallery_Create(PalmGalleryHandle* gallery);
+
+/**
+ * Add palm models to a shared gallery. Unlike PalmID_AddModels, this function completes synchronously
+ * and does not produce a message. The models become visible to the attached handles at once.
+ *
+ * @param gallery A shared gallery handle.
+ * @param model_data An array of num_models pointers to palm model data streams.
+ * @param model_data_sizes An array of num_models sizes of the palm model data streams in bytes.
+ * @param num_models The number of models to add.
+ * @param success An optional array of num_models flags to write into. A flag is set to non-zero if the
+ *                corresponding model was successfully added. May be null.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmGallery_AddModels(PalmGalleryHandle gallery, const void* const* model_data, const uint32_t* model_data_sizes, int32_t num_models, uint8_t* success);
+
+/**
+ * Memory map a gallery file written by 'PalmID_WriteGallery' into a shared gallery. See 'PalmID_MapGallery',
+ * except that templates are decoded into the gallery's own cache rather than the cache of a handle.
+ *
+ * @param gallery A shared gallery handle.
+ * @param path A pointer to the file path string. The string is expected to end with '\0'.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmGallery_Map(PalmGalleryHandle gallery, const char* path);
+
+/**
+ * Release the caller's reference to a shared gallery. The gallery is destroyed once it is also detached
+ * from all handles.
+ *
+ * @param gallery A pointer to the shared gallery handle to release. It is reset upon return.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmGallery_Release(PalmGalleryHandle* gallery);
+
+/**
+ * Get the counters of the decoded template cache of a shared gallery, accumulated over all attached handles.
+ *
+ * @param gallery A shared gallery handle.
+ * @param stats A pointer to a PalmCacheStats to write into.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmGallery_GetCacheStats(PalmGalleryHandle gallery, PalmCacheStats* stats);
+
+/**
+ * Get the memory currently used by a shared gallery. Add it once, not per attached handle, to the
+ * PalmMemoryStats of the handles of a process to plan the gallery size a node can hold.
+ *
+ * @param gallery A shared gallery handle.
+ * @param stats A pointer to a PalmGalleryMemoryStats to write into.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmGallery_GetMemoryStats(PalmGalleryHandle gallery, PalmGalleryMemoryStats* stats);
+
+/**
+ * Attach a shared gallery to a palm biometrics handle, so that its models are available to PalmID_Match
+ * in addition to the models added to the handle itself. The handle holds a reference to the gallery until
+ * it is detached or destroyed. The gallery is read-only through the handle: PalmID_RemoveModel and model
+ * updates by PalmID_Match do not apply to its models.
+ *
+ * @param handle A palm biometrics handle.
+ * @param gallery A shared gallery handle. Attaching a gallery replaces any gallery previously attached.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_AttachGallery(PalmIDHandle handle, PalmGalleryHandle gallery);
+
+/**
+ * Detach the shared gallery attached with 'PalmID_AttachGallery' and release the handle's reference to it.
+ *
+ * @param handle A palm biometrics handle.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_DetachGallery(PalmIDHandle handle);
+
+/**
+ * Attempt to match a live palm against a set of existing palm model(s). The result(s)
+ * will be returned in a PalmMatchingResult message.
+ *
+ * Successful matches may update existing models to improve future matches.
+ * To keep models up to date, use 'PalmID_GetModel' to update stored models.
+ *
+ * A match reads the version of the model database that is current when matching starts and never
+ * waits for concurrent calls that add, remove or update models. Those changes are published atomically
+ * as a new version of the database and are visible to matches started afterwards.
+ *
+ * When "sidedness_partitioning" is enabled and the sidedness of the live model is known with a confidence
+ * above "sidedness_confidence", models of the other hand are skipped even if their ids are given. Models of
+ * undetermined sidedness are always matched.
+ *
+ * When "max_pending_matches" requests are already pending, this function returns ePalm_Overloaded. To bound
+ * the time a request may take, set "match_timeout".
+ *
+ * @param handle A palm biometrics handle.
+ * @param live_model    A pointer to a live model to match against the database of models
+ * @param model_ids     A pointer to the IDs of models that will be matched to when a palm is detected.
+ * @param num_model_ids The number of models stored in models array.
+ * @param type  The type of palm being matched. When a model consists of multiple images of different types,
+ *              only the images correspond to the requested type are used in matching. To match multiple
+ *              types (modalities), call PalmID_Match multiple times.
+ * @param score_threshold  A threshold in [0, 1] for returned matching results. Only matches with scores higher
+ *              than the threshold will be returned.
+ * @param update_model  A flag to indicate whether to update the to be matched model when the match passes. Set
+ *              this parameter to zero or non-zero to disable or enable the model update. Note that the model is
+ *              not always updated when the match passes, other conditions need to be satisfied as well. When the
+ *              model is indeed updated, the 'updated' flag in PalmMatch will be set to non-zero. In this case,
+ *              the user is recommended to call PalmID_GetModel to retrieve the updated model, unless
+ *              "inline_updated_model" is enabled, in which case the updated model is already in the
+ *              PalmMatchingResult.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_Match(PalmIDHandle handle, const void* live_model, int32_t live_model_size, const PalmModelID* model_ids, int32_t num_model_ids, PalmType type, float score_threshold, uint8_t update_model);
+
+/**
+ * Decrypt and deserialize a live model once so that it can be matched several times, for example
+ * against different sets of model ids or for both palm types, with 'PalmID_MatchParsed'.
+ * Unlike PalmID_Match, this function completes synchronously and does not produce a message.
+ *
+ * Parsed live models should be freed after use with 'PalmID_FreeLiveModel'.
+ *
+ * @param handle A palm biometrics handle.
+ * @param live_model      A pointer to a live model data stream.
+ * @param live_model_size The size of the live model data stream in bytes.
+ * @param live            A pointer to a parsed live model handle to write into.
+ *
+ * @return ePalm_InvalidModel if the model data cannot be decrypted or deserialized.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_ParseLiveModel(PalmIDHandle handle, const void* live_model, int32_t live_model_size, PalmLiveModelHandle* live);
+
+/**
+ * Attempt to match a parsed live palm against a set of existing palm model(s). This behaves the same
+ * as 'PalmID_Match' and the result(s) will be returned in a PalmMatchingResult message.
+ *
+ * @param handle A palm biometrics handle.
+ * @param live  A live model handle obtained from 'PalmID_ParseLiveModel'. The handle is not consumed and
+ *              may be used in further calls, including calls that are still pending.
+ * @param request_tag A value copied to PalmMatchingResult.request_tag, to correlate the result with this call.
+ *
+ * For the remaining parameters, see 'PalmID_Match'.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_MatchParsed(PalmIDHandle handle, PalmLiveModelHandle live, const PalmModelID* model_ids, int32_t num_model_ids, PalmType type, float score_threshold, uint8_t update_model, uint64_t request_tag);
+
+/**
+ * Attempt to match a parsed live palm like 'PalmID_MatchParsed', but give up once the deadline has passed.
+ * In that case the PalmMatchingResult message has the status ePalm_Timeout and contains the matches found
+ * among the models scored before the deadline.
+ *
+ * @param handle A palm biometrics handle.
+ * @param deadline The time, as returned by 'PalmID_Now', after which matching stops. A request whose deadline
+ *                 has already passed is rejected with ePalm_Timeout without producing a message.
+ *
+ * For the remaining parameters, see 'PalmID_MatchParsed'.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_MatchUntil(PalmIDHandle handle, PalmLiveModelHandle live, const PalmModelID* model_ids, int32_t num_model_ids, PalmType type, float score_threshold, uint8_t update_model, uint64_t request_tag, int64_t deadline);
+
+/**
+ * Attempt to match several parsed live palms against the same set of existing palm model(s) in a single
+ * pass over the models, for example to serve match requests from several clients that arrive at about the
+ * same time. Each live model produces its own PalmMatchingResult message, identical to the one
+ * 'PalmID_MatchParsed' would produce for it.
+ *
+ * @param handle A palm biometrics handle.
+ * @param lives An array of num_lives live model handles obtained from 'PalmID_ParseLiveModel'.
+ * @param request_tags An array of num_lives values copied to the PalmMatchingResult.request_tag of the result of
+ *                     the corresponding live model. May be null, in which case the tags are 0.
+ * @param num_lives The number of live models to match.
+ * @param deadline The time, as returned by 'PalmID_Now', after which matching stops, or 0 for none. Each live
+ *                 model still being matched then produces a message with the status ePalm_Timeout, as with
+ *                 'PalmID_MatchUntil'. A batch whose deadline has already passed is rejected with ePalm_Timeout
+ *                 without producing messages.
+ *
+ * When fewer than num_lives requests are available under "max_pending_matches", the whole batch is rejected
+ * with ePalm_Overloaded.
+ *
+ * For the remaining parameters, see 'PalmID_Match'.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_MatchBatch(PalmIDHandle handle, const PalmLiveModelHandle* lives, const uint64_t* request_tags, int32_t num_lives, const PalmModelID* model_ids, int32_t num_model_ids, PalmType type, float score_threshold, uint8_t update_model, int64_t deadline);
+
+/**
+ * Deallocates a live model returned from 'PalmID_ParseLiveModel'. Matches that are still pending on the
+ * live model keep it alive until they finish.
+ *
+ * @param handle A palm biometrics handle.
+ * @param live A pointer to the live model handle to free. It is reset upon return.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_FreeLiveModel(PalmIDHandle handle, PalmLiveModelHandle* live);
+
+/**
+ * Get the shard a palm model belongs to when models are partitioned across several handles or processes.
+ * The shard is the 32-bit FNV-1a hash of the 20 bytes of the model id (offset basis 2166136261, prime
+ * 16777619) modulo num_shards. This definition will not change between releases, so every process and
+ * version computes the same assignment, and it may be reimplemented by services that do not link the SDK.
+ *
+ * @param model_id A pointer to a palm model ID.
+ * @param num_shards The number of shards, greater than zero.
+ *
+ * @return The shard index in [0, num_shards).
+ */
+PALM_EXPORT uint32_t PALM_CALL PalmModelID_Shard(const PalmModelID* model_id, uint32_t num_shards);
+
+/**
+ * Merge the matching results of the same live model obtained from several shards into a single list of
+ * matches sorted by decreasing score. A model matched by more than one result, e.g. when a request was sent
+ * again to another replica of a slow shard, is only listed once with its highest score.
+ *
+ * @param results An array of num_results pointers to matching results for the same live model and type.
+ * @param num_results The number of matching results.
+ * @param matches An array to hold the merged matches. The caller needs to allocate the memory.
+ * @param num_matches A pointer to an integer holding the capacity of the matches array. This parameter is
+ *                    updated upon return with the number of merged matches.
+ *
+ * @note: If the matches array is too small to hold all merged matches, this function will return an
+ * ePalm_OutOfMemory error, and the num_matches parameter will be updated with the number of matches needed.
+ *
+ * @return ePalm_InvalidArgument if the results are not for the same live model and type.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_MergeMatchingResults(const PalmMatchingResult* const* results, int32_t num_results, PalmMatch* matches, int32_t* num_matches);
+
+/**
+ * Add a message to the message queue.  This is useful when palm capture and matching happen on
+ * different systems and messages need to be passed between them, such as a client and server.
+ *
+ * If the message cannot be added to the queue due to format errors, an error status will be returned.
+ * If the queue is full (see "message_queue_capacity"), ePalm_QueueFull is returned.
+ *
+ * For a MessageMatchingResult, only the fields up to and including 'matches' are read, so that callers filling
+ * a PalmMatchingResult field by field on the stack keep working. The queued copy has null 'updated_models' and
+ * a 'request_tag' of 0, whatever the caller's structure holds. A decoded message from 'PalmMessage_Deserialize'
+ * keeps both fields, and can be used directly instead of being queued.
+ *
+ * @param handle A palm biometrics handle.
+ * @param message A PalmMessage to be copied and sent to the message queue.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_QueueMessage(PalmIDHandle handle, PalmMessage message);
+
+/**
+ * Wait for a message to become available. The function will wait until either
+ * a message becomes available or the specified timeout duration elapses.
+ * Messages are returned in the order they were queued, unless "message_priority" is set to "results".
+ *
+ * PalmMessages should be freed after use with 'PalmID_FreeMessage'
+ *
+ * @param handle A palm biometrics handle.
+ * @param message A memory address of a PalmMessage to write into.
+ * @param timeout The maximum length of time, in milliseconds, to wait for a
+ *                message to become available.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_WaitMessage(PalmIDHandle handle, PalmMessage* message, int32_t timeout);
+
+/**
+* Deallocates a message returned from 'PalmID_WaitMessage'. The message payload is a single block, so
+* this takes constant time regardless of the message contents.
+*
+* @param handle A palm biometrics handle.
+* @param message The PalmMessage to free.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_FreeMessage(PalmIDHandle handle, PalmMessage message);
+
+/**
+ * Wait for messages to become available and return up to 'max_messages' of them at once. The function
+ * waits like PalmID_WaitMessage for the first message, then returns it together with any other messages
+ * that are already available, without waiting for more.
+ *
+ * PalmMessages should be freed after use with 'PalmID_FreeMessages' or 'PalmID_FreeMessage'.
+ *
+ * @param handle A palm biometrics handle.
+ * @param messages An array of max_messages PalmMessages to write into.
+ * @param max_messages The maximum number of messages to return.
+ * @param num_messages A pointer to an integer to hold the number of messages written to the messages array.
+ * @param timeout The maximum length of time, in milliseconds, to wait for a
+ *                message to become available.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_WaitMessages(PalmIDHandle handle, PalmMessage* messages, int32_t max_messages, int32_t* num_messages, int32_t timeout);
+
+/**
+* Deallocates several messages returned from 'PalmID_WaitMessages' or 'PalmID_WaitMessage'.
+*
+* @param handle A palm biometrics handle.
+* @param messages An array of num_messages PalmMessages to free.
+* @param num_messages The number of messages to free.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_FreeMessages(PalmIDHandle handle, const PalmMessage* messages, int32_t num_messages);
+
+/**
+ * Get a file descriptor that is readable while messages are available in the message queue of a handle,
+ * so that it can be monitored with poll, epoll or kqueue together with other descriptors. When it becomes
+ * readable, drain the queue with PalmID_WaitMessage or PalmID_WaitMessages and a timeout of 0; the descriptor
+ * itself must not be read from. The descriptor is an eventfd on Linux and a pipe on other platforms. It is
+ * owned by the handle and closed by PalmID_Destroy.
+ *
+ * @param handle A palm biometrics handle.
+ * @param fd A pointer to an integer to hold the file descriptor.
+ *
+ * @return ePalm_UnexpectedRequest on platforms without file descriptors.
+ */
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_GetMessageFd(PalmIDHandle handle, int* fd);
+
+/**
+* Get the statistics of the message queue of a handle.
+*
+* @param handle A palm biometrics handle.
+* @param stats A pointer to a PalmQueueStats to write into.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_GetQueueStats(PalmIDHandle handle, PalmQueueStats* stats);
+
+/**
+* Register a callback for a message type. Messages of this type are then passed to the callback as soon as
+* they are produced, instead of being added to the message queue and returned by PalmID_WaitMessage.
+* By default the callback is invoked on the SDK thread that produced the message, see 'PalmID_SetMessageExecutor'.
+*
+* The callback of a message type is not invoked concurrently with itself, and receives messages in the order they
+* were produced. The results of PalmID_Capture, PalmID_AddModels and PalmID_RemoveModels requests are produced in
+* the order the requests were made. A callback is never invoked from within an SDK function on the thread that
+* called it, and the callback may itself call any SDK function for the handle, such as PalmID_FreeMessage,
+* PalmID_Match or PalmID_SetMessageCallback, except PalmID_Destroy.
+*
+* Replacing or clearing a callback, and destroying the handle, waits until invocations of the previous callback
+* in progress on other threads have returned, so that its user_data can be released afterwards. A callback may
+* replace or clear itself. Messages handed to the executor but not yet passed to the previous callback are
+* delivered as if they were produced after the change.
+*
+* Messages of a type with a registered callback are produced even if PalmID_SetMessageFilter excludes that type.
+*
+* @param handle A palm biometrics handle.
+* @param type The message type to register the callback for.
+* @param callback The function to call, or null to queue messages of this type again.
+* @param user_data A pointer passed as is to the callback.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_SetMessageCallback(PalmIDHandle handle, ePalmMessageType type, PalmMessageCallback callback, void* user_data);
+
+/**
+* Set an executor on which message callbacks are invoked, instead of the SDK thread that produced the message.
+*
+* @param handle A palm biometrics handle.
+* @param executor The executor function, or null to invoke callbacks on the producing thread.
+* @param executor_data A pointer passed as is to the executor.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_SetMessageExecutor(PalmIDHandle handle, PalmExecutor executor, void* executor_data);
+
+/**
+* Select the message types a handle produces. Messages of other types are never created or queued, unless a
+* callback is registered for their type with PalmID_SetMessageCallback. By default all message types are produced.
+*
+* @param handle A palm biometrics handle.
+* @param type_mask A combination of PALM_MESSAGE_MASK(type) for the desired message types, for example
+*                  PALM_MESSAGE_MASK(MessageMatchingResult) | PALM_MESSAGE_MASK(MessageCaptureResult).
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmID_SetMessageFilter(PalmIDHandle handle, uint32_t type_mask);
+
+/**
+* Encode a message in the wire format described by PalmWireHeader, for example to send a capture result
+* from a client to a server that passes it to PalmID_QueueMessage.
+*
+* @param message The PalmMessage to encode.
+* @param buffer A pointer to hold the encoded message. The caller needs to allocate the memory.
+* @param buffer_size A pointer to an integer to hold the buffer size. This parameter is updated upon return
+* with the actual number of bytes written to the buffer.
+*
+* @note: If the size of the buffer is insufficient to hold the encoded message, this function will return an
+* ePalm_OutOfMemory error, and the buffer_size parameter will be updated with the actual size needed.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmMessage_Serialize(const PalmMessage* message, void* buffer, uint32_t* buffer_size);
+
+/**
+* Decode a message encoded by 'PalmMessage_Serialize'. The native message structures, such as the
+* PalmMatchingResult and its array of PalmMatch, are built in a caller-provided storage area, while model data
+* streams are not copied: the 'data' pointers of the decoded message point into the buffer, which has no
+* alignment requirement. Both the buffer and the storage must outlive the message. The decoded message must not
+* be freed with PalmID_FreeMessage; PalmID_QueueMessage copies it, so both can be reused afterwards.
+*
+* @param buffer A pointer to the encoded message.
+* @param buffer_size The number of bytes available in the buffer.
+* @param storage A pointer to hold the native message structures. The caller needs to allocate the memory,
+*                aligned for any type like memory returned by malloc.
+* @param storage_size A pointer to an integer to hold the storage size. This parameter is updated upon return
+*                     with the actual number of bytes used in the storage.
+* @param message A memory address of a PalmMessage to write into.
+* @param message_size A pointer to an integer to hold the number of bytes of the buffer used by the message,
+*                     so that several messages can be decoded from the same buffer. May be null.
+*
+* @note: If the size of the storage is insufficient to hold the decoded message, this function will return an
+* ePalm_OutOfMemory error, and the storage_size parameter will be updated with the actual size needed.
+*
+* @return ePalm_SerializationError if the buffer does not contain a complete message of a supported version.
+*/
+PALM_EXPORT ePalmStatus PALM_CALL PalmMessage_Deserialize(const void* buffer, uint32_t buffer_size, void* storage, uint32_t* storage_size, PalmMessage* message, uint32_t* message_size);
+
+/**
+* Insert a palm image to a palm frame. This function creates a new palm image of specified type and size and allocates memory
+* for its image data buffer. If the frame already contains the maximum number of images, this function does nothing.
+*
+* @param frame   A palm frame to add the new image.
+*        width   Image width
+*        height  Image height
+*        depth   Image depth in bits.  Must be 8 (Grayscale) or 24 (RGB)
+*        channel Image channel source
+*/
+PALM_EXPORT void PALM_CALL PalmFrame_AddImage(PalmFrame* frame, uint32_t width, uint32_t height, uint32_t depth, PalmType type);
+
+/**
+* Insert a palm image to a palm frame. This function creates a new palm image from a binary file such as a BMP, PNG, or JPG
+* and allocates memory for its image data buffer. If the frame already contains the maximum number of images, this function does nothing.
+*
+* @param frame     A palm frame to add the new image.
+*        file_data The binary file data
+*        file_size Size of the file data
+*        channel   Image channel source
+*/
+PALM_EXPORT void PALM_CALL PalmFrame_AddImageFromFile(PalmFrame* frame, const void* file_data, uint32_t file_size, PalmType type);
+
+/**
+* Create an empty palm frame with no images.
+*
+* @param frame      A pointer to a palm frame that will be initialized as an empty frame with no images.
+
+* @note call PalmFrame_AddImage to insert an image into a frame. Note that the memory for the palm frame and images are allocated
+*       inside the PalmAPI shared library.
+*/
+PALM_EXPORT void PALM_CALL PalmFrame_Create(PalmFrame* frame);
+
+/**
+* Free a palm frame and its images.
+*
+* @param frame A palm frame allocated inside Palm API shared library.
+*
+* @note This function releases the memories allocated for a frame and all its images.
+*/
+PALM_EXPORT void PALM_CALL PalmFrame_Free(PalmFrame* frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PALM_ID_H__ */
@@ -0,0 +1,499 @@
+// Copyright (c) 2020 RedRock Biometrics. All rights reserved.
+#ifndef __PALM_ID_ASYNC_HPP__
+#define __PALM_ID_ASYNC_HPP__
+
+/**
+ * A header-only C++20 layer over the message API of PalmID.h. Operations such as PalmID_Capture or
+ * PalmID_Match return awaitables that are resumed with their result message when it arrives, so that
+ * coroutines can issue many concurrent requests without a thread blocked in PalmID_WaitMessage.
+ *
+ *   palm::AsyncHandle async(handle);
+ *   palm::Message capture = co_await async.Capture(PalmStrictness_Authenticate, PalmLiveness_None);
+ *   if (capture.type() != MessageCaptureResult || capture.status() != ePalm_Success) {
+ *     co_return capture.status();  // MessageNone if the capture could not be started
+ *   }
+ *   palm::Message match = co_await async.Match(capture->capture_result->data, capture->capture_result->data_size,
+ *                                              ids, num_ids, PalmType_Print, 0.5f, 0);
+ *
+ * An operation that cannot be issued resumes at once with a MessageNone whose message pointers are null, so the
+ * type and status of every result must be checked before its payload is used.
+ */
+
+#include "PalmID.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace palm {
+
+/**
+ * Owns a PalmMessage and frees it with PalmID_FreeMessage.
+ */
+class Message {
+ public:
+  Message() noexcept : handle_(), message_(), owned_(false) {}
+
+  /**
+   * Take ownership of a message returned by the SDK.
+   */
+  Message(PalmIDHandle handle, PalmMessage message) noexcept : handle_(handle), message_(message), owned_(true) {}
+
+  /**
+   * An empty message of type MessageNone carrying an error status, for operations that could not be issued.
+   */
+  explicit Message(ePalmStatus status) noexcept : handle_(), message_(), owned_(false) {
+    message_.type = MessageNone;
+    message_.status = status;
+  }
+
+  Message(Message&& other) noexcept : handle_(other.handle_), message_(other.message_), owned_(other.owned_) {
+    other.owned_ = false;
+  }
+
+  Message& operator=(Message&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      handle_ = other.handle_;
+      message_ = other.message_;
+      owned_ = other.owned_;
+      other.owned_ = false;
+    }
+    return *this;
+  }
+
+  Message(const Message&) = delete;
+  Message& operator=(const Message&) = delete;
+
+  ~Message() { Reset(); }
+
+  ePalmMessageType type() const noexcept { return message_.type; }
+  ePalmStatus status() const noexcept { return message_.status; }
+  const PalmMessage& get() const noexcept { return message_; }
+
+  /**
+   * Access the union of message pointers, e.g. 'message->matching_result'.
+   */
+  const decltype(PalmMessage::message)* operator->() const noexcept { return &message_.message; }
+
+ private:
+  void Reset() noexcept {
+    if (owned_) {
+      PalmID_FreeMessage(handle_, message_);
+      owned_ = false;
+    }
+  }
+
+  PalmIDHandle handle_;
+  PalmMessage message_;
+  bool owned_;
+};
+
+namespace detail {
+
+/**
+ * How an operation recognizes its result message: the next message of its type, the message for its model id,
+ * or the matching result carrying its request tag.
+ */
+struct Key {
+  enum Kind { kNone, kModelId, kTag };
+  Kind kind = kNone;
+  PalmModelID model_id = {};
+  uint64_t tag = 0;
+};
+
+/**
+ * The result message an operation is waiting for.
+ */
+struct Pending {
+  ePalmMessageType type = MessageNone;
+  Key key;
+
+  enum State { kIssuing, kSuspended, kCompleted };
+  std::atomic<int> state{kIssuing};
+  std::coroutine_handle<> waiter;
+  Message result;
+};
+
+struct ModelIdHash {
+  size_t operator()(const PalmModelID& model_id) const noexcept {
+    // 32-bit FNV-1a, as PalmModelID_Shard.
+    uint32_t hash = 2166136261u;
+    for (uint8_t byte : model_id.id) {
+      hash = (hash ^ byte) * 16777619u;
+    }
+    return hash;
+  }
+};
+
+struct ModelIdEqual {
+  bool operator()(const PalmModelID& a, const PalmModelID& b) const noexcept {
+    return std::memcmp(a.id, b.id, sizeof(a.id)) == 0;
+  }
+};
+
+/**
+ * The operations of an AsyncHandle that are waiting for their result message, indexed so that a message finds
+ * its operation in constant time: matches by request tag, model requests by model id, and other operations
+ * in a FIFO per message type.
+ */
+class Registry {
+ public:
+  uint64_t NextTag() noexcept { return next_tag_.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * Held while registering and issuing an operation without a key, so that the order in which such operations
+   * are registered is the order in which their requests are made, and thus the order of their results.
+   */
+  std::mutex& IssueMutex(ePalmMessageType type) noexcept { return issue_mutexes_[type % kMaxTypes]; }
+
+  void Add(Pending* pending) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (pending->key.kind) {
+      case Key::kTag:
+        by_tag_.emplace(pending->key.tag, pending);
+        break;
+      case Key::kModelId:
+        by_model_id_[pending->key.model_id].push_back(pending);
+        break;
+      default:
+        unkeyed_[pending->type % kMaxTypes].push_back(pending);
+        break;
+    }
+  }
+
+  /**
+   * Unregister an operation whose result has not arrived. Only cancellation and failed requests get here, so
+   * searching the queue of a model id or message type is acceptable.
+   */
+  bool Remove(Pending* pending) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (pending->key.kind) {
+      case Key::kTag:
+        return by_tag_.erase(pending->key.tag) != 0;
+      case Key::kModelId: {
+        auto it = by_model_id_.find(pending->key.model_id);
+        if (it == by_model_id_.end() || !Erase(it->second, pending)) {
+          return false;
+        }
+        if (it->second.empty()) {
+          by_model_id_.erase(it);
+        }
+        return true;
+      }
+      default:
+        return Erase(unkeyed_[pending->type % kMaxTypes], pending);
+    }
+  }
+
+  /**
+   * Hand a message to the operation waiting for it and resume that operation if it is already suspended. The
+   * message is freed if no operation is waiting for it.
+   */
+  void Complete(Message message) {
+    Pending* pending = nullptr;
+    int previous = Pending::kIssuing;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending = Take(message.get());
+      if (pending != nullptr) {
+        pending->result = std::move(message);
+        previous = pending->state.exchange(Pending::kCompleted);
+      }
+    }
+    if (pending != nullptr && previous == Pending::kSuspended) {
+      pending->waiter.resume();
+    }
+  }
+
+ private:
+  static constexpr int kMaxTypes = 32;
+
+  static bool Erase(std::deque<Pending*>& queue, Pending* pending) {
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+      if (*it == pending) {
+        queue.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Pending* Take(const PalmMessage& message) {
+    if (message.type == MessageMatchingResult && message.message.matching_result != nullptr) {
+      auto it = by_tag_.find(message.message.matching_result->request_tag);
+      if (it == by_tag_.end()) {
+        return nullptr;
+      }
+      Pending* pending = it->second;
+      by_tag_.erase(it);
+      return pending;
+    }
+    if (message.type == MessageGetModelResult && message.message.get_model_result != nullptr) {
+      auto it = by_model_id_.find(message.message.get_model_result->model_id);
+      if (it == by_model_id_.end()) {
+        return nullptr;
+      }
+      Pending* pending = it->second.front();
+      it->second.pop_front();
+      if (it->second.empty()) {
+        by_model_id_.erase(it);
+      }
+      return pending;
+    }
+    if (message.type < 0 || message.type >= kMaxTypes || unkeyed_[message.type].empty()) {
+      return nullptr;
+    }
+    Pending* pending = unkeyed_[message.type].front();
+    unkeyed_[message.type].pop_front();
+    return pending;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, Pending*> by_tag_;
+  std::unordered_map<PalmModelID, std::deque<Pending*>, ModelIdHash, ModelIdEqual> by_model_id_;
+  std::deque<Pending*> unkeyed_[kMaxTypes];
+  std::mutex issue_mutexes_[kMaxTypes];
+  std::atomic<uint64_t> next_tag_{1};
+};
+
+}  // namespace detail
+
+/**
+ * An awaitable issuing a request when awaited and resuming with its result message. If the request cannot be
+ * issued, the coroutine is not suspended and the result is a MessageNone carrying the error status.
+ *
+ * Destroying a coroutine suspended on an operation cancels waiting for the result, which is freed when it
+ * arrives. This must not race with the result arriving.
+ */
+template <typename Issue>
+class Operation {
+ public:
+  Operation(detail::Registry& registry, ePalmStatus status, ePalmMessageType type, const detail::Key& key,
+            Issue issue)
+      : registry_(registry), status_(status), issue_(std::move(issue)) {
+    pending_.type = type;
+    pending_.key = key;
+  }
+
+  Operation(const Operation&) = delete;
+  Operation& operator=(const Operation&) = delete;
+
+  ~Operation() {
+    // A completed operation was already removed by Registry::Complete.
+    if (registered_ && pending_.state.load() != detail::Pending::kCompleted) {
+      registry_.Remove(&pending_);
+    }
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> waiter) {
+    pending_.waiter = waiter;
+    bool issued;
+    if (pending_.key.kind == detail::Key::kNone) {
+      std::lock_guard<std::mutex> lock(registry_.IssueMutex(pending_.type));
+      issued = Register();
+    } else {
+      issued = Register();
+    }
+    if (!issued) {
+      return false;
+    }
+    // The result may already have arrived on another thread, in which case it is not resumed from there.
+    return pending_.state.exchange(detail::Pending::kSuspended) != detail::Pending::kCompleted;
+  }
+
+  Message await_resume() noexcept { return std::move(pending_.result); }
+
+ private:
+  bool Register() {
+    if (status_ == ePalm_Success) {
+      registry_.Add(&pending_);
+      registered_ = true;
+      status_ = issue_();
+      if (status_ == ePalm_Success || !registry_.Remove(&pending_)) {
+        return true;
+      }
+    }
+    pending_.result = Message(status_);
+    return false;
+  }
+
+  detail::Registry& registry_;
+  ePalmStatus status_;
+  bool registered_ = false;
+  Issue issue_;
+  detail::Pending pending_;
+};
+
+/**
+ * Registers message callbacks on a palm biometrics handle and resumes awaiting coroutines with their
+ * result messages. Coroutines are resumed on the thread that invokes the callback, i.e. the SDK thread
+ * producing the message or the executor set with PalmID_SetMessageExecutor.
+ *
+ * The callbacks for MessageCaptureResult, MessageMatchingResult, MessageGetModelResult, MessageAddModelsResult
+ * and MessageRemoveModelsResult are owned by this object while it exists, so these types are produced even if
+ * PalmID_SetMessageFilter excludes them. Messages of these types that no operation is waiting for are freed.
+ * Matches are correlated with their results by request tag and model requests by model id. Captures and bulk
+ * model changes rely on their results being produced in the order the requests were made.
+ *
+ * Destroying this object waits for callbacks in progress on other threads to return (see
+ * PalmID_SetMessageCallback). All operations must complete or be cancelled before it is destroyed.
+ */
+class AsyncHandle {
+ public:
+  explicit AsyncHandle(PalmIDHandle handle) : handle_(handle), status_(ePalm_Success) {
+    for (ePalmMessageType type : kResultTypes) {
+      status_ = PalmID_SetMessageCallback(handle_, type, &AsyncHandle::OnMessage, this);
+      if (status_ != ePalm_Success) {
+        Unregister();
+        break;
+      }
+    }
+  }
+
+  ~AsyncHandle() {
+    if (status_ == ePalm_Success) {
+      Unregister();
+    }
+  }
+
+  AsyncHandle(const AsyncHandle&) = delete;
+  AsyncHandle& operator=(const AsyncHandle&) = delete;
+
+  PalmIDHandle handle() const noexcept { return handle_; }
+
+  /**
+   * The status of registering the message callbacks. If it is not ePalm_Success, every operation completes
+   * immediately with this status.
+   */
+  ePalmStatus status() const noexcept { return status_; }
+
+  /**
+   * See 'PalmID_Capture'. Resumes with the MessageCaptureResult.
+   */
+  auto Capture(PalmStrictness strictness, PalmLiveness liveness) {
+    PalmIDHandle handle = handle_;
+    return MakeOperation(MessageCaptureResult, detail::Key(),
+                         [=] { return PalmID_Capture(handle, strictness, liveness); });
+  }
+
+  /**
+   * See 'PalmID_Match'. The live model is parsed with PalmID_ParseLiveModel and matched with a request tag, so
+   * that the operation resumes with its own MessageMatchingResult even if other matches of the same live model
+   * are pending.
+   */
+  auto Match(const void* live_model, int32_t live_model_size, const PalmModelID* model_ids, int32_t num_model_ids,
+             PalmType type, float score_threshold, uint8_t update_model) {
+    PalmIDHandle handle = handle_;
+    detail::Key key = TagKey();
+    uint64_t tag = key.tag;
+    return MakeOperation(MessageMatchingResult, key, [=] {
+      PalmLiveModelHandle live;
+      ePalmStatus status = PalmID_ParseLiveModel(handle, live_model, live_model_size, &live);
+      if (status == ePalm_Success) {
+        status = PalmID_MatchParsed(handle, live, model_ids, num_model_ids, type, score_threshold, update_model, tag);
+        PalmID_FreeLiveModel(handle, &live);
+      }
+      return status;
+    });
+  }
+
+  /**
+   * See 'PalmID_MatchParsed'. Resumes with the MessageMatchingResult of this request.
+   */
+  auto Match(PalmLiveModelHandle live, const PalmModelID* model_ids, int32_t num_model_ids, PalmType type,
+             float score_threshold, uint8_t update_model) {
+    PalmIDHandle handle = handle_;
+    detail::Key key = TagKey();
+    uint64_t tag = key.tag;
+    return MakeOperation(MessageMatchingResult, key, [=] {
+      return PalmID_MatchParsed(handle, live, model_ids, num_model_ids, type, score_threshold, update_model, tag);
+    });
+  }
+
+  /**
+   * See 'PalmID_MatchUntil'. Resumes with the MessageMatchingResult of this request, whose status is
+   * ePalm_Timeout if the deadline passed before all models were scored.
+   */
+  auto MatchUntil(PalmLiveModelHandle live, const PalmModelID* model_ids, int32_t num_model_ids, PalmType type,
+                  float score_threshold, uint8_t update_model, int64_t deadline) {
+    PalmIDHandle handle = handle_;
+    detail::Key key = TagKey();
+    uint64_t tag = key.tag;
+    return MakeOperation(MessageMatchingResult, key, [=] {
+      return PalmID_MatchUntil(handle, live, model_ids, num_model_ids, type, score_threshold, update_model, tag,
+                               deadline);
+    });
+  }
+
+  /**
+   * See 'PalmID_GetModel'. Resumes with the MessageGetModelResult for 'model_id'. Pending requests for the same
+   * model receive its results in the order they arrive.
+   */
+  auto GetModel(const PalmModelID& model_id) {
+    PalmIDHandle handle = handle_;
+    detail::Key key;
+    key.kind = detail::Key::kModelId;
+    key.model_id = model_id;
+    return MakeOperation(MessageGetModelResult, key, [=] { return PalmID_GetModel(handle, &key.model_id); });
+  }
+
+  /**
+   * See 'PalmID_AddModels'. Resumes with the MessageAddModelsResult.
+   */
+  auto AddModels(const void* const* model_data, const uint32_t* model_data_sizes, int32_t num_models) {
+    PalmIDHandle handle = handle_;
+    return MakeOperation(MessageAddModelsResult, detail::Key(),
+                         [=] { return PalmID_AddModels(handle, model_data, model_data_sizes, num_models); });
+  }
+
+  /**
+   * See 'PalmID_RemoveModels'. Resumes with the MessageRemoveModelsResult.
+   */
+  auto RemoveModels(const PalmModelID* model_ids, int32_t num_model_ids) {
+    PalmIDHandle handle = handle_;
+    return MakeOperation(MessageRemoveModelsResult, detail::Key(),
+                         [=] { return PalmID_RemoveModels(handle, model_ids, num_model_ids); });
+  }
+
+ private:
+  static constexpr ePalmMessageType kResultTypes[] = {MessageCaptureResult, MessageMatchingResult,
+                                                      MessageGetModelResult, MessageAddModelsResult,
+                                                      MessageRemoveModelsResult};
+
+  detail::Key TagKey() noexcept {
+    detail::Key key;
+    key.kind = detail::Key::kTag;
+    key.tag = registry_.NextTag();
+    return key;
+  }
+
+  template <typename Issue>
+  Operation<Issue> MakeOperation(ePalmMessageType type, const detail::Key& key, Issue issue) {
+    return Operation<Issue>(registry_, status_, type, key, std::move(issue));
+  }
+
+  void Unregister() noexcept {
+    for (ePalmMessageType type : kResultTypes) {
+      PalmID_SetMessageCallback(handle_, type, nullptr, nullptr);
+    }
+  }
+
+  static void PALM_CALL OnMessage(PalmIDHandle handle, PalmMessage message, void* user_data) {
+    static_cast<AsyncHandle*>(user_data)->registry_.Complete(Message(handle, message));
+  }
+
+  PalmIDHandle handle_;
+  ePalmStatus status_;
+  detail::Registry registry_;
+};
+
+}  // namespace palm
+
+#endif /* __PALM_ID_ASYNC_HPP__ */